@@ -13,17 +13,16 @@
 #include "parser/parser.h"
 
 
-JitCompiler::JitCompiler(std::vector<ParsedFunction>&& function_definitions, JitRuntime& runtime) :
-    runtime(runtime) 
-{
-    for (auto& function: function_definitions) {
-        functions_definitions.push_back(std::move(function));
-    }
-}
+JitCompiler::JitCompiler(SourceFilePtr&& source, JitRuntime& runtime) :
+    source(std::move(source)),
+    function_sources(split_functions(this->source->contents())),
+    runtime(runtime)
+{}
 
 auto JitCompiler::trigger_compilation(uint32_t function_id) -> void {
     auto code = Assembly();
-    auto& function_definition = functions_definitions[function_id];
+    // functions are only parsed once they are first invoked
+    auto function_definition = parse_function(function_sources[function_id]);
     
     // generate the code
     for (auto& command: function_definition) {
@@ -38,5 +37,5 @@ auto JitCompiler::trigger_compilation(uint32_t function_id) -> void {
 }
 
 auto JitCompiler::main_function() -> uint32_t {
-    return functions_definitions.size() - 1;
+    return function_sources.size() - 1;
 }
\ No newline at end of file
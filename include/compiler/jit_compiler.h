@@ -7,9 +7,9 @@
 
 class JitCompiler {
     public:
-        JitCompiler(std::vector<ParsedFunction>&& function_definitions, JitRuntime& runtime);
+        JitCompiler(SourceFilePtr&& source, JitRuntime& runtime);
 
-        // trigger_compilation will compile the function with the specified id, it is a special
+        // trigger_compilation will parse and compile the function with the specified id, it is a special
         // method emitted into the JITed assembly and is invoked when a function has not yet been
         // compiled.
         auto trigger_compilation(uint32_t function_id) -> void;
@@ -18,6 +18,8 @@ class JitCompiler {
         auto main_function() -> uint32_t;
 
     private:
-        std::vector<ParsedFunction> functions_definitions;
+        // function_sources are views into the mapped source, so the source must outlive them
+        SourceFilePtr source;
+        std::vector<SourceFunction> function_sources;
         JitRuntime& runtime;
 };
\ No newline at end of file
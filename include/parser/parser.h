@@ -2,6 +2,9 @@
 
 #include <memory>
 #include <vector>
+#include <string>
+#include <string_view>
+#include <stddef.h>
 
 #include "compiler/command.h"
 
@@ -10,6 +13,40 @@ template <typename T>
 using Function = std::vector<T>;
 using ParsedFunction = Function<std::unique_ptr<ICommand>>;
 
+// a SourceFunction is a view into the mapped source of a single (untokenised) function
+using SourceFunction = std::string_view;
 
-// parse_file will take some istream and return a series of parsed functions
-auto parse_file(std::istream& file_stream) -> std::vector<ParsedFunction>;
\ No newline at end of file
+// SourceFile is a read only mmap of a program's source, the parser scans the mapping in place
+// rather than copying the program into memory. Inputs that cannot be mapped (pipes, FIFOs, etc.)
+// are read into a buffer owned by the SourceFile instead
+class SourceFile {
+    public:
+        SourceFile(const char* path);
+        auto contents() const -> std::string_view;
+
+        // is_valid is false if the source could not be opened or loaded
+        auto is_valid() const -> bool;
+
+        const char* region = nullptr;
+        size_t size = 0;
+        bool mapped = false;
+    private:
+        bool valid = false;
+        std::string buffer;
+};
+
+// SourceFileDeleter is a custom deleter for the SourceFile class
+class SourceFileDeleter {
+    public:
+        void operator()(SourceFile* source) const noexcept;
+};
+
+using SourceFilePtr = std::unique_ptr<SourceFile, SourceFileDeleter>;
+
+
+// split_functions will find the boundaries of each function within the source, the functions
+// are not tokenised until they are parsed
+auto split_functions(std::string_view source) -> std::vector<SourceFunction>;
+
+// parse_function will tokenise and parse the source of a single function
+auto parse_function(SourceFunction source) -> ParsedFunction;
@@ -1,8 +1,6 @@
 #include <iostream>
 #include <vector>
 #include <memory>
-#include <istream>
-#include <fstream>
 
 #include "compiler/jit_compiler.h"
 #include "parser/parser.h"
@@ -20,14 +18,16 @@ __attribute__((noinline)) auto trigger_compilation(uint32_t function_id) -> void
 
 int main(int argc, char* argv[]) {
     auto program_file = argv[1];
-    std::ifstream file_stream;
-    file_stream.open(program_file);
+    auto source = SourceFilePtr(new SourceFile(program_file));
+    if (!source->is_valid()) {
+        std::cerr << "failed to load program: " << program_file << std::endl;
+        return 1;
+    }
 
-    auto program = parse_file(file_stream);
     auto jit_runtime = JitRuntime(&trigger_compilation);
     jit_compiler = std::make_unique<JitCompiler>(
         JitCompiler(
-            std::move(program), 
+            std::move(source), 
             jit_runtime
         )
     );
@@ -1,10 +1,16 @@
 #include <iostream>
 #include <string>
+#include <string_view>
 #include <vector>
-#include <istream>
 #include <memory>
 #include <optional>
 #include <functional>
+#include <algorithm>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 #include "compiler/command.h"
 #include "parser/parser.h"
@@ -26,18 +32,103 @@ using TokenisedFunction = Function<Token>;
 using ParsedFunction = Function<std::unique_ptr<ICommand>>;
 
 
-// tokenise takes some input stream and decomposes it into a sequence of Tokens
-auto tokenise(std::istream& input_file) -> std::vector<TokenisedFunction> {
-    auto functions = std::vector<TokenisedFunction>();
+SourceFile::SourceFile(const char* path) {
+    auto fd = open(path, O_RDONLY);
+    if (fd == -1) {
+        perror("open");
+        return;
+    }
+
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) == -1) {
+        perror("fstat");
+        close(fd);
+        return;
+    }
+
+    // only regular files can be mapped and report a meaningful size, anything else (pipes, FIFOs,
+    // /dev/stdin) is read into a buffer until EOF
+    if (!S_ISREG(file_stat.st_mode)) {
+        char chunk[65536];
+        ssize_t bytes_read;
+        while ((bytes_read = read(fd, chunk, sizeof(chunk))) > 0) {
+            buffer.append(chunk, bytes_read);
+        }
+
+        if (bytes_read == -1) {
+            perror("read");
+            close(fd);
+            return;
+        }
+
+        region = buffer.data();
+        size = buffer.size();
+        valid = true;
+        close(fd);
+        return;
+    }
+
+    // mmap rejects empty mappings, an empty regular file is just an empty source
+    if (file_stat.st_size > 0) {
+        auto mapping = mmap(nullptr, file_stat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            perror("mmap");
+            close(fd);
+            return;
+        }
+
+        region = static_cast<const char*>(mapping);
+        size = file_stat.st_size;
+        mapped = true;
+    }
+
+    // the mapping stays valid after the descriptor is closed
+    valid = true;
+    close(fd);
+}
+
+auto SourceFile::contents() const -> std::string_view {
+    return std::string_view(region, size);
+}
+
+auto SourceFile::is_valid() const -> bool {
+    return valid;
+}
+
+auto SourceFileDeleter::operator()(SourceFile* source) const noexcept -> void {
+    if (source->mapped) {
+        munmap(const_cast<char*>(source->region), source->size);
+    }
+    delete source;
+}
+
+
+// split_functions only looks for the '/' function separators, memchr is vectorised by libc
+// so this is far cheaper than tokenising the entire program upfront
+auto split_functions(std::string_view source) -> std::vector<SourceFunction> {
+    auto functions = std::vector<SourceFunction>();
+    auto function_start = source.data();
+    auto source_end = source.data() + source.size();
+
+    while (function_start != source_end) {
+        auto separator = static_cast<const char*>(memchr(function_start, '/', source_end - function_start));
+        if (separator == nullptr) { break; }
+
+        functions.push_back(SourceFunction(function_start, separator - function_start));
+        function_start = separator + 1;
+    }
+
+    // push back the last function
+    functions.push_back(SourceFunction(function_start, source_end - function_start));
+    return functions;
+}
+
+// tokenise takes the source of a single function and decomposes it into a sequence of Tokens
+auto tokenise(SourceFunction source) -> TokenisedFunction {
     auto function = TokenisedFunction();
 
-    char c;
-    while (input_file.get(c)) {
+    for (auto c : source) {
         switch (c) {
-            case '/':
-                functions.push_back(std::move(function));
-                function = TokenisedFunction();
-                break;
             case '>': function.push_back(Token::MoveRight); break;
             case '<': function.push_back(Token::MoveLeft); break;
             case '+': function.push_back(Token::Increment); break;
@@ -51,9 +142,7 @@ auto tokenise(std::istream& input_file) -> std::vector<TokenisedFunction> {
         }
     }
 
-    // push back the last function
-    functions.push_back(function);
-    return functions;
+    return function;
 }
 
 // Contains parser definitions for each of the possible commands
@@ -104,41 +193,35 @@ namespace Parsers {
 };
 
 
-// the parse command will take a token stream and transform it into a sequence of commands
+// the parse command will take a function's token stream and transform it into a sequence of commands
 // each command in the sequence will be responsible for emitting the appropriate assembly code
-auto parse_tokens(std::vector<TokenisedFunction> tokens) -> std::vector<ParsedFunction> {
-    auto functions = std::vector<ParsedFunction>();
-
-    for (auto function : tokens) {
-        auto compiled_func = ParsedFunction();
-        auto func_start = std::begin(function);
-        auto func_end  = std::end(function);
-
-        auto try_match_parser = [&] (auto& parser) {
-            auto command = parser(func_start, func_end);
-            if (command.has_value()) {
-                compiled_func.push_back(std::move(command.value()));
-                return true;
-            }
-
-            return false;
-        };
-
-        while (func_start != func_end) {
-            auto matched_parser = std::any_of(std::begin(Parsers::parsers), std::end(Parsers::parsers), try_match_parser);
-            if (!matched_parser) {
-                // this should never happen !
-                perror("Failed to match a parser!! This is so sad and deeply un-esteemed.");
-            }
+auto parse_tokens(TokenisedFunction& function) -> ParsedFunction {
+    auto compiled_func = ParsedFunction();
+    auto func_start = std::begin(function);
+    auto func_end  = std::end(function);
+
+    auto try_match_parser = [&] (auto& parser) {
+        auto command = parser(func_start, func_end);
+        if (command.has_value()) {
+            compiled_func.push_back(std::move(command.value()));
+            return true;
         }
 
-        functions.push_back(std::move(compiled_func));
+        return false;
+    };
+
+    while (func_start != func_end) {
+        auto matched_parser = std::any_of(std::begin(Parsers::parsers), std::end(Parsers::parsers), try_match_parser);
+        if (!matched_parser) {
+            // this should never happen !
+            perror("Failed to match a parser!! This is so sad and deeply un-esteemed.");
+        }
     }
 
-    return functions;
+    return compiled_func;
 }
 
-auto parse_file(std::istream& file_stream) -> std::vector<ParsedFunction> {
-    auto tokens = tokenise(file_stream);
+auto parse_function(SourceFunction source) -> ParsedFunction {
+    auto tokens = tokenise(source);
     return parse_tokens(tokens);
 }
\ No newline at end of file